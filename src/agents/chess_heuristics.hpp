@@ -0,0 +1,14 @@
+#pragma once
+
+#include <array>
+
+#include "../games/chess.hpp"
+#include "minimax_agent.hpp"
+
+// Computes the change in material balance, from black's perspective, that
+// results from making `move`.
+constexpr auto kBlackAdvantageOnCapture = [](const ChessMove &move) {
+  constexpr std::array<Score, 13> kMaterialValues = {
+      0, 200, 9, 5, 3, 3, 1, -200, -9, -5, -3, -3, -1};
+  return kMaterialValues[move.captured];
+};
@@ -0,0 +1,347 @@
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "agents/chess_heuristics.hpp"
+#include "agents/minimax_agent.hpp"
+#include "games/chess.hpp"
+#include "tourney_base.hpp"
+
+// Counts every call to the global allocation functions so that benchmarks can
+// report allocations per operation.
+size_t allocations_count = 0;
+
+void* operator new(size_t size) {
+  allocations_count++;
+  void* ptr = std::malloc(size == 0 ? 1 : size);  // NOLINT
+  if (ptr == nullptr) {
+    std::abort();
+  }
+  return ptr;
+}
+
+void* operator new[](size_t size) { return operator new(size); }
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }  // NOLINT
+
+void operator delete[](void* ptr) noexcept { operator delete(ptr); }
+
+void operator delete(void* ptr, size_t /*size*/) noexcept {
+  operator delete(ptr);
+}
+
+void operator delete[](void* ptr, size_t /*size*/) noexcept {
+  operator delete(ptr);
+}
+
+// Prevents the compiler from discarding a value computed by a benchmark.
+template <typename T>
+void DoNotOptimize(const T& value) {
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// Reads hardware counters via `perf_event_open` where the kernel permits it.
+// The counters are opened as one group led by the first, so that they are
+// scheduled together, and are scaled up if the kernel multiplexed the group.
+// Counters that cannot be opened are reported as unavailable.
+class PerfCounters {
+ public:
+  static constexpr std::array<std::string_view, 4> kNames = {
+      "cycles", "instructions", "branch_misses", "cache_misses"};
+
+  using Readings = std::array<std::optional<uint64_t>, kNames.size()>;
+
+  PerfCounters() {
+#ifdef __linux__
+    constexpr std::array<uint64_t, kNames.size()> kConfigs = {
+        PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+        PERF_COUNT_HW_BRANCH_MISSES, PERF_COUNT_HW_CACHE_MISSES};
+    for (size_t i = 0; i < kNames.size(); ++i) {
+      // Members cannot be opened without a leader.
+      if (i > 0 && fds_[0] < 0) {
+        break;
+      }
+      perf_event_attr attr{};
+      attr.type = PERF_TYPE_HARDWARE;
+      attr.size = sizeof(attr);
+      attr.config = kConfigs[i];
+      attr.disabled = i == 0 ? 1 : 0;
+      attr.exclude_kernel = 1;
+      attr.exclude_hv = 1;
+      attr.read_format =
+          PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+      const int group_fd = i == 0 ? -1 : fds_[0];
+      fds_[i] = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1,
+                                         group_fd, 0));  // NOLINT
+    }
+#endif
+  }
+
+  PerfCounters(const PerfCounters&) = delete;
+  PerfCounters& operator=(const PerfCounters&) = delete;
+  PerfCounters(PerfCounters&&) = delete;
+  PerfCounters& operator=(PerfCounters&&) = delete;
+
+  ~PerfCounters() {
+#ifdef __linux__
+    // Closes the members before the leader.
+    for (auto fd = fds_.rbegin(); fd != fds_.rend(); ++fd) {
+      if (*fd >= 0) {
+        close(*fd);
+      }
+    }
+#endif
+  }
+
+  void Start() {
+#ifdef __linux__
+    if (fds_[0] >= 0) {
+      ioctl(fds_[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);   // NOLINT
+      ioctl(fds_[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);  // NOLINT
+    }
+#endif
+  }
+
+  [[nodiscard]] Readings Stop() {
+    Readings readings;
+#ifdef __linux__
+    if (fds_[0] < 0) {
+      return readings;
+    }
+    ioctl(fds_[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);  // NOLINT
+    for (size_t i = 0; i < kNames.size(); ++i) {
+      // Matches the layout selected by `read_format`.
+      struct {
+        uint64_t value;
+        uint64_t time_enabled;
+        uint64_t time_running;
+      } count{};
+      if (fds_[i] < 0 || read(fds_[i], &count, sizeof(count)) != sizeof(count) ||
+          count.time_running == 0) {
+        continue;
+      }
+      readings[i] = static_cast<uint64_t>(
+          static_cast<double>(count.value) *
+          static_cast<double>(count.time_enabled) /
+          static_cast<double>(count.time_running));
+    }
+#endif
+    return readings;
+  }
+
+ private:
+  std::array<int, kNames.size()> fds_ = {-1, -1, -1, -1};
+};
+
+// Runs one round of the measured operation and returns how many operations
+// the round performed.
+using Round = std::function<size_t()>;
+
+struct Benchmark {
+  std::string name;
+  Round round;
+};
+
+// Repeats `round` until it has run for at least `kMinDuration`, then repeats it
+// that many times again while measuring. Prints one JSON object per line.
+void Run(const Benchmark& benchmark, PerfCounters& counters) {
+  using Clock = std::chrono::steady_clock;
+  static constexpr auto kMinDuration = std::chrono::milliseconds(200);
+
+  size_t rounds = 0;
+  for (const auto begin = Clock::now(); Clock::now() - begin < kMinDuration;) {
+    benchmark.round();
+    rounds++;
+  }
+
+  size_t ops = 0;
+  const size_t allocations_before = allocations_count;
+  counters.Start();
+  const auto begin = Clock::now();
+  for (size_t i = 0; i < rounds; ++i) {
+    ops += benchmark.round();
+  }
+  const auto end = Clock::now();
+  const auto readings = counters.Stop();
+  const size_t allocations = allocations_count - allocations_before;
+
+  const auto elapsed_ns =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count();
+  const auto per_op = [ops](auto total) {
+    return static_cast<double>(total) / static_cast<double>(ops);
+  };
+  std::printf(R"({"benchmark":"%s","ops":%zu,"ns_per_op":%.3f,)",
+              benchmark.name.c_str(), ops, per_op(elapsed_ns));
+  std::printf(R"("allocs_per_op":%.3f)", per_op(allocations));
+  for (size_t i = 0; i < PerfCounters::kNames.size(); ++i) {
+    const std::string name(PerfCounters::kNames[i]);
+    if (readings[i].has_value()) {
+      std::printf(R"(,"%s_per_op":%.3f)", name.c_str(), per_op(*readings[i]));
+    } else {
+      std::printf(R"(,"%s_per_op":null)", name.c_str());
+    }
+  }
+  std::printf("}\n");
+  std::fflush(stdout);
+}
+
+struct Position {
+  std::string name;
+  // Stores the moves leading to the position from the starting position.
+  std::vector<std::string> moves;
+  // Stores algebraic notation fed to `Parse` in the position.
+  std::vector<std::string> inputs;
+};
+
+// Stores the positions every benchmark is run over. Pawn captures omit the
+// file of origin since `Parse` does not accept it.
+const std::vector<Position> kPositions = {
+    {.name = "start", .moves = {}, .inputs = {"e4", "d4", "Nf3", "Nc3"}},
+    {.name = "open",
+     .moves = {"e4", "e5", "Nf3", "Nc6", "Bc4", "Bc5", "d3", "d6"},
+     .inputs = {"Bg5", "Nxe5", "Bxf7", "Kd2"}},
+    {.name = "captures",
+     .moves = {"e4", "d5", "xd5", "Qxd5", "Nc3", "Qa5", "d4", "Nf6", "Nf3",
+               "Bf5", "Bd2", "e5"},
+     .inputs = {"Qe2", "Bc4", "Nxe5", "xe5"}},
+};
+
+// Replays the moves of `position` from the starting position and ensures each
+// of its inputs parses, such that `Parse` is only timed on legal moves.
+Chess SetUp(const Position& position) {
+  const auto exit_on_illegal = [&position](const auto& move,
+                                           const std::string& input) {
+    if (!move.has_value()) {
+      std::cerr << "Cannot set up position " << position.name << ": illegal move "
+                << input << "\n";
+      std::exit(1);  // NOLINT
+    }
+  };
+
+  auto game = Chess(/*white_perspective=*/true);
+  for (const auto& input : position.moves) {
+    const auto move = game.Parse(input);
+    exit_on_illegal(move, input);
+    game.MakeMove(*move);
+  }
+  for (const auto& input : position.inputs) {
+    exit_on_illegal(game.Parse(input), input);
+  }
+  return game;
+}
+
+std::vector<Benchmark> MakeBenchmarks() {
+  std::vector<Benchmark> benchmarks;
+  for (const auto& position : kPositions) {
+    const auto suffix = "/" + position.name;
+
+    benchmarks.push_back({.name = "GenerateLegalMoves" + suffix,
+                          .round = [game = SetUp(position)] {
+                            DoNotOptimize(game.GenerateLegalMoves());
+                            return size_t{1};
+                          }});
+
+    const auto moves = SetUp(position).GenerateLegalMoves();
+    benchmarks.push_back({.name = "MakeUnmakeMove" + suffix,
+                          .round = [game = SetUp(position), moves]() mutable {
+                            // Keeps the compiler from merging each pair.
+                            for (const auto& move : moves) {
+                              game.MakeMove(move);
+                              DoNotOptimize(game);
+                              game.UnmakeMove(move);
+                              DoNotOptimize(game);
+                            }
+                            return moves.size();
+                          }});
+
+    // Measures `GetToSquares` separately for each piece type of the side to
+    // move, the only side the engine ever computes squares for.
+    static constexpr std::array<std::string_view, 6> kPieceNames = {
+        "King", "Queen", "Rook", "Bishop", "Knight", "Pawn"};
+    for (size_t type = 0; type < kPieceNames.size(); ++type) {
+      const Chess game = SetUp(position);
+      std::vector<Square> froms;
+      for (Square square = 0; square < 64; ++square) {
+        const Piece piece = game.PieceAt(square);
+        if (piece != kEmpty && Chess::IsWhite(piece) == game.IsWhiteToMove() &&
+            static_cast<size_t>(piece - 1) % 6 == type) {
+          froms.push_back(square);
+        }
+      }
+      if (froms.empty()) {
+        continue;
+      }
+      benchmarks.push_back(
+          {.name = "GetToSquares/" + std::string(kPieceNames[type]) + suffix,
+           .round = [game, froms] {
+             for (const Square from : froms) {
+               DoNotOptimize(game.GetToSquares(from));
+             }
+             return froms.size();
+           }});
+    }
+
+    benchmarks.push_back(
+        {.name = "Parse" + suffix,
+         .round = [game = SetUp(position), inputs = position.inputs] {
+           for (const auto& input : inputs) {
+             DoNotOptimize(game.Parse(input));
+           }
+           return inputs.size();
+         }});
+
+    benchmarks.push_back({.name = "ToString" + suffix,
+                          .round = [game = SetUp(position)] {
+                            DoNotOptimize(game.ToString());
+                            return size_t{1};
+                          }});
+
+    // Plays white's first input so that, as in `main.cpp`, the agent searches
+    // for black. Shares the game between copies of the round, since the agent
+    // refers to it.
+    auto game = std::make_shared<Chess>(SetUp(position));
+    game->MakeMove(*game->Parse(position.inputs[0]));
+    auto agent = std::make_shared<MinimaxAgent<ChessMove>>(
+        *game, 3, kBlackAdvantageOnCapture);
+    benchmarks.push_back({.name = "MinimaxAgent/depth3" + suffix,
+                          .round = [game, agent] {
+                            // Silences the messages printed by `SelectMove`.
+                            auto* const buffer = std::cout.rdbuf(nullptr);
+                            DoNotOptimize(agent->SelectMove());
+                            std::cout.rdbuf(buffer);
+                            std::cout.clear();
+                            return size_t{1};
+                          }});
+  }
+  return benchmarks;
+}
+
+// Runs every benchmark whose name contains the optional command-line filter.
+int main(int argc, char* argv[]) {
+  const std::string_view filter = argc > 1 ? argv[1] : "";  // NOLINT
+  PerfCounters counters;
+  for (const auto& benchmark : MakeBenchmarks()) {
+    if (benchmark.name.find(filter) != std::string::npos) {
+      Run(benchmark, counters);
+    }
+  }
+  return 0;
+}
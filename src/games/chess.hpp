@@ -1,3 +1,5 @@
+#pragma once
+
 #include <algorithm>
 #include <array>
 #include <cstdint>
@@ -114,6 +116,20 @@ class Chess final : public Game<ChessMove> {  // NOLINT
   [[nodiscard]] std::optional<ChessMove> Parse(
       const std::string &input) const override;
 
+  // Computes a vector of squares that the piece at `from` can move to.
+  [[nodiscard]] std::vector<Square> GetToSquares(Square from) const;
+
+  // Returns the piece occupying `square`, which may be `kEmpty`.
+  [[nodiscard]] Piece PieceAt(Square square) const { return board_[square]; }
+
+  // Reports whether it is white's turn.
+  [[nodiscard]] bool IsWhiteToMove() const { return white_to_move_; }
+
+  // Reports whether `piece` belongs to white, which `kEmpty` does not.
+  [[nodiscard]] static bool IsWhite(const Piece piece) {
+    return (piece >= kWhiteKing) && (piece <= kWhitePawn);
+  }
+
  private:
   // https://en.wikipedia.org/wiki/Chess_symbols_in_Unicode
   static constexpr std::array<std::string, 13> kUnicodePieces = {
@@ -126,10 +142,6 @@ class Chess final : public Game<ChessMove> {  // NOLINT
     return (8 * (rank - '1')) + (file - 'a');
   }
 
-  static bool IsWhite(const Piece piece) {
-    return (piece >= kWhiteKing) && (piece <= kWhitePawn);
-  }
-
   [[nodiscard]] bool IsOccupied(Square square) const {
     return board_[square] != kEmpty;
   }
@@ -158,9 +170,6 @@ class Chess final : public Game<ChessMove> {  // NOLINT
 
   void InsertToSquaresPawn(Square from, std::vector<Square> &tos) const;
 
-  // Computes a vector of squares that the piece at `from` can move to.
-  [[nodiscard]] std::vector<Square> GetToSquares(Square from) const;
-
   // Stores the board rank-major such that the squares laid out in `board_` like
   // so: 1a ... 1h 2a ... 2h ... 7h 8a ... 8h.
   std::array<Piece, 64> board_{};
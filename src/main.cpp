@@ -1,19 +1,13 @@
-#include <array>
 #include <iostream>
 #include <memory>
 #include <vector>
 
+#include "agents/chess_heuristics.hpp"
 #include "agents/human_agent.hpp"
 #include "agents/minimax_agent.hpp"
 #include "games/chess.hpp"
 #include "tourney_base.hpp"
 
-constexpr auto kBlackAdvantageOnCapture = [](const ChessMove& move) {
-  constexpr std::array<Score, 13> kMaterialValues = {
-      0, 200, 9, 5, 3, 3, 1, -200, -9, -5, -3, -3, -1};
-  return kMaterialValues[move.captured];
-};
-
 int main() {
   // Create the game and the agents playing it.
   auto game = Chess(/*white_perspective=*/true);